@@ -11,6 +11,9 @@
 #include "esp_timer.h"
 #ifdef ESP_PLATFORM
 	#include <rom/ets_sys.h>
+	#include "esp_attr.h"
+#else
+	#define	IRAM_ATTR
 #endif
 
 #include <string.h>
@@ -39,17 +42,52 @@ static u32_t STstat = 0;								// status 1=Running
 	static u32_t STcore = 0;							// Core# 0/1
 #endif
 
+#if	(systimerCPU > 0)
+	static u32_t STcpu = 0;								// 1=on-CPU/off-CPU attribution enabled
+	static TaskHandle_t STcpuTask[stMAX_NUM] = { 0 };	// tagged owner task, NULL if not running
+	static u32_t STtOff[stMAX_NUM], STtOut[stMAX_NUM];	// current measurement, maintained by switch hooks
+	static portMUX_TYPE STcpuMux = portMUX_INITIALIZER_UNLOCKED;
+	#ifndef CONFIG_FREERTOS_UNICORE
+		static u8_t STcpuCore[stMAX_NUM];				// Core# owner was switched out on
+		static u32_t STcpuBad = 0;						// switched out & in on different cores
+	#endif
+#endif
+
+#if	(systimerLAPS > 0)
+	#define	stLAP_IDLE					0xFF
+
+	typedef struct {
+		const char * Tag;
+		const char * const * Name;						// Stages x stage names
+		u32_t tStart, tMark;							// time run started, current stage opened
+		u32_t tTotal;									// end-to-end of last run, if Pend
+		u8_t Type, Stages, Stage;						// Stage = open stage or stLAP_IDLE
+		u8_t Pend;										// tTotal not yet added to Data[Stages]
+		#ifndef CONFIG_FREERTOS_UNICORE
+			u8_t Core;									// Core# 0/1 run was started on
+		#endif
+		systimer_t Data[systimerLAP_STAGES + 1];		// per stage + end-to-end [Stages]
+	} systimer_lap_t;
+
+	static systimer_lap_t SLdata[systimerLAPS] = { [0 ... systimerLAPS-1] = { .Stage = stLAP_IDLE } };
+#endif
+
+#if	(systimerREPORT > 0)
+	// Stop & reset MUST mark after statistics are updated so a snapshot taken before is redone,
+	// start marks before the timestamp, a snapshot missing Last/Count is redone by the next stop
+	#define	stMARK_DIRTY(n)				__atomic_fetch_or(&STdirty, 1UL << (n), __ATOMIC_RELEASE)
+	static u32_t STdirty = 0;							// changed since last snapshot
+#else
+	#define	stMARK_DIRTY(n)
+#endif
+
 // ###################################### Private APIs #############################################
 
 /**
- * @brief	Reset all the timer values for a single timer #
- * @brief 	This function does NOT reset SGmin & SGmax. To reset Min/Max use vSysTimerInit()
- * @brief	which allows for the type to be changed as well as specifying new Min/Max values.
- * @param 	TimNum
+ * @brief	Clear the statistics & scatter group counters of a timer structure
+ * @param	pST pointer to timer structure
  */
-static void vSysTimerResetCounter(u8_t TimNum) {
-	systimer_t *pST	= &STdata[TimNum];
-	STstat		&= ~(1UL << TimNum);					// clear active status ie STOP
+static void vSysTimerClear(systimer_t * pST) {
 	pST->Sum	= 0ULL;
 	pST->Last	= 0;
 	pST->Count	= 0;
@@ -58,6 +96,89 @@ static void vSysTimerResetCounter(u8_t TimNum) {
 	#if	(systimerSCATTER > 2)
 		memset(&pST->Group, 0, SO_MEM(systimer_t, Group));
 	#endif
+	#if	(systimerCPU > 0)
+		pST->Off	= 0ULL;
+		pST->CpuMin	= 0xFFFFFFFF;
+		pST->CpuMax	= 0;
+		pST->OffMax	= 0;
+	#endif
+}
+
+#if	(systimerCPU > 0)
+/**
+ * @brief	update the running timer mask held in the application task tag of an owner task
+ * @param	xTask owner task handle
+ * @param	Set timer bit(s) to add
+ * @param	Clr timer bit(s) to remove
+ */
+static void vSysTimerCpuTag(TaskHandle_t xTask, u32_t Set, u32_t Clr) {
+	portENTER_CRITICAL(&STcpuMux);						// start & stop/reset from different tasks
+	u32_t Mask = (u32_t) (uintptr_t) xTaskGetApplicationTaskTag(xTask);
+	vTaskSetApplicationTaskTag(xTask, (TaskHookFunction_t) (uintptr_t) ((Mask & ~Clr) | Set));
+	portEXIT_CRITICAL(&STcpuMux);
+}
+
+/**
+ * @brief	stop on-CPU/off-CPU tracking of a timer by removing it from the owner task tag
+ * @param	TimNum
+ * @return	owner task handle, NULL if timer was not started with attribution enabled
+ */
+static TaskHandle_t xSysTimerCpuUntag(u8_t TimNum) {
+	TaskHandle_t xOwner = STcpuTask[TimNum];
+	if (xOwner) {
+		vSysTimerCpuTag(xOwner, 0, 1UL << TimNum);
+		STcpuTask[TimNum] = NULL;
+	}
+	return xOwner;
+}
+#endif
+
+/**
+ * @brief	Reset all the timer values for a single timer #
+ * @brief 	This function does NOT reset SGmin & SGmax. To reset Min/Max use vSysTimerInit()
+ * @brief	which allows for the type to be changed as well as specifying new Min/Max values.
+ * @param 	TimNum
+ */
+static void vSysTimerResetCounter(u8_t TimNum) {
+	STstat		&= ~(1UL << TimNum);					// clear active status ie STOP
+	#if	(systimerCPU > 0)
+		xSysTimerCpuUntag(TimNum);
+	#endif
+	vSysTimerClear(&STdata[TimNum]);
+	stMARK_DIRTY(TimNum);
+}
+
+/**
+ * @brief	update statistics & scatter groups with a new elapsed interval
+ * @param	pST pointer to timer structure
+ * @param	tElap measured interval based on type (CLOCKs or TICKs)
+ */
+static void vSysTimerUpdate(systimer_t * pST, u32_t tElap) {
+	pST->Sum += tElap;									// update sum of all times
+	pST->Last = tElap;									// and save as previous/last time
+	// update Min & Max if required
+	if (pST->Min > tElap)								// if required
+		pST->Min = tElap;								// update new minimum
+	if (pST->Max < tElap)
+		pST->Max = tElap;								// and/or new maximum
+	#if	(systimerSCATTER > 2)
+		int Idx;
+		if (tElap <= pST->SGmin) {						// LE minimum ?
+			Idx = 0;									// first bucket
+		} else if (tElap >= pST->SGmax) {				// GE maximum ?	
+			Idx = systimerSCATTER-1;					// last bucket
+		} else {										// anything inbetween
+			u32_t tBlock = (pST->SGmax - pST->SGmin) / (systimerSCATTER - 2);
+			u32_t tDiff = tElap - pST->SGmin;
+			Idx = 1 + (tDiff/tBlock);					// calculate bucket number/index
+		}
+		if (INRANGE(0, Idx, systimerSCATTER-1))	{
+			++pST->Group[Idx];							// update bucket count
+		} else {
+			SL_CRIT("l=%lu h=%lu n=%lu i=%d", pST->SGmin, pST->SGmax, tElap, Idx);
+		}
+		IF_myASSERT(debugRESULT, INRANGE(0, Idx, systimerSCATTER-1));
+	#endif
 }
 
 // ################################### Public Control APIs #########################################
@@ -99,8 +220,20 @@ u32_t xSysTimerStart(u8_t TimNum) {
 		}
 	}
 	#endif
+	#if	(systimerCPU > 0)
+	if (STcpu & (1UL << TimNum)) {
+		xSysTimerCpuUntag(TimNum);						// restarted without stop
+		STtOff[TimNum] = 0;
+		#ifndef CONFIG_FREERTOS_UNICORE
+			__atomic_fetch_and(&STcpuBad, ~(1UL << TimNum), __ATOMIC_RELAXED);
+		#endif
+		STcpuTask[TimNum] = xTaskGetCurrentTaskHandle();
+		vSysTimerCpuTag(STcpuTask[TimNum], 1UL << TimNum, 0);	// hooks start tracking
+	}
+	#endif
 	STstat |= (1UL << TimNum);							// Mark as started & running
 	++STdata[TimNum].Count;
+	stMARK_DIRTY(TimNum);								// before timestamp, keep overhead out of interval
 	return STdata[TimNum].Last = xSysTimerGetTime(Type);
 }
 
@@ -108,6 +241,9 @@ u32_t xSysTimerStop(u8_t TimNum) {
 	IF_myASSERT(debugPARAM, TimNum < stMAX_NUM);
 	int Type = xSysTimerGetType(TimNum);
 	u32_t tNow = xSysTimerGetTime(Type);				// capture stop time as early as possible
+	#if	(systimerCPU > 0)
+		TaskHandle_t xOwner = xSysTimerCpuUntag(TimNum);	// hooks stop at stop timestamp
+	#endif
 	STstat &= ~(1UL << TimNum);							//  mark timer as stopped
 	systimer_t *pST	= &STdata[TimNum];
 	/* Adjustments made to CCOUNT cause discrepancies between readings from different cores.
@@ -116,38 +252,34 @@ u32_t xSysTimerStop(u8_t TimNum) {
 	#ifndef CONFIG_FREERTOS_UNICORE
 	if (Type == stCLOCKS) {
 		int xCoreID = (STcore & (1UL << TimNum)) ? 1 : 0;
-		if (xCoreID != xPortGetCoreID()) {
+		int Bad = (xCoreID != xPortGetCoreID());
+		#if	(systimerCPU > 0)
+			if (xOwner && (STcpuBad & (1UL << TimNum)))	// switched out & in on different cores, tOff invalid
+				Bad = 1;
+		#endif
+		if (Bad) {
 			++pST->Skip;
+			stMARK_DIRTY(TimNum);
 			return 0;
 		}
 	}
 	#endif
 	u32_t tElap = tNow - pST->Last;						// cal culate elapsed time
-	pST->Sum += tElap;									// update sum of all times
-	pST->Last = tElap;									// and save as previous/last time
-	// update Min & Max if required
-	if (pST->Min > tElap)								// if required
-		pST->Min = tElap;								// update new minimum
-	if (pST->Max < tElap)
-		pST->Max = tElap;								// and/or new maximum
-	#if	(systimerSCATTER > 2)
-		int Idx;
-		if (tElap <= pST->SGmin) {						// LE minimum ?
-			Idx = 0;									// first bucket
-		} else if (tElap >= pST->SGmax) {				// GE maximum ?	
-			Idx = systimerSCATTER-1;					// last bucket
-		} else {										// anything inbetween
-			u32_t tBlock = (pST->SGmax - pST->SGmin) / (systimerSCATTER - 2);
-			u32_t tDiff = tElap - pST->SGmin;
-			Idx = 1 + (tDiff/tBlock);					// calculate bucket number/index
-		}
-		if (INRANGE(0, Idx, systimerSCATTER-1))	{
-			++pST->Group[Idx];							// update bucket count
-		} else {
-			SL_CRIT("l=%lu h=%lu n=%lu i=%d", pST->SGmin, pST->SGmax, tElap, Idx);
-		}
-		IF_myASSERT(debugRESULT, INRANGE(0, Idx, systimerSCATTER-1));
+	vSysTimerUpdate(pST, tElap);
+	#if	(systimerCPU > 0)
+	if (xOwner) {
+		u32_t tOff = (STtOff[TimNum] < tElap) ? STtOff[TimNum] : tElap;	// preempted/blocked, clamp
+		u32_t tCpu = tElap - tOff;
+		pST->Off += tOff;
+		if (pST->OffMax < tOff)
+			pST->OffMax = tOff;
+		if (pST->CpuMin > tCpu)
+			pST->CpuMin = tCpu;
+		if (pST->CpuMax < tCpu)
+			pST->CpuMax = tCpu;
+	}
 	#endif
+	stMARK_DIRTY(TimNum);
 	return tElap;
 }
 
@@ -166,6 +298,47 @@ void vSysTimerResetCountersMask(u32_t TimerMask) {
 	}
 }
 
+#if	(systimerCPU > 0)
+void vSysTimerSetCpuMask(u32_t TimerMask) {
+	TimerMask &= (1UL << stMAX_NUM) - 1;
+	vSysTimerResetCountersMask(STcpu ^ TimerMask);		// changed timers, restart statistics
+	STcpu = TimerMask;
+}
+
+void IRAM_ATTR vSysTimerTaskSwitchedOut(void) {
+	u32_t Todo = (u32_t) (uintptr_t) xTaskGetApplicationTaskTagFromISR(NULL);
+	if (Todo == 0)										// not an owner task, single tag load
+		return;
+	#ifndef CONFIG_FREERTOS_UNICORE
+		u8_t Core = xPortGetCoreID();
+	#endif
+	for (; Todo; Todo &= Todo - 1) {
+		int Num = __builtin_ctz(Todo);
+		STtOut[Num] = xSysTimerGetTime(xSysTimerGetType(Num));
+		#ifndef CONFIG_FREERTOS_UNICORE
+			STcpuCore[Num] = Core;
+		#endif
+	}
+}
+
+void IRAM_ATTR vSysTimerTaskSwitchedIn(void) {
+	u32_t Todo = (u32_t) (uintptr_t) xTaskGetApplicationTaskTagFromISR(NULL);
+	if (Todo == 0)										// not an owner task, single tag load
+		return;
+	for (; Todo; Todo &= Todo - 1) {
+		int Num = __builtin_ctz(Todo);
+		int Type = xSysTimerGetType(Num);
+		#ifndef CONFIG_FREERTOS_UNICORE
+		if (Type == stCLOCKS && STcpuCore[Num] != xPortGetCoreID()) {
+			__atomic_fetch_or(&STcpuBad, 1UL << Num, __ATOMIC_RELAXED);	// CCOUNT not comparable
+			continue;
+		}
+		#endif
+		STtOff[Num] += (u32_t) xSysTimerGetTime(Type) - STtOut[Num];
+	}
+}
+#endif
+
 // ################################### Public Status APIs ##########################################
 
 u32_t xSysTimerIsRunning(u8_t TimNum) {
@@ -227,6 +400,117 @@ u64_t xSysTimerGetElapsedSecs(u8_t TimNum) {
 	return tElap;
 }
 
+// ################################# Lap/split timer support #######################################
+
+#if	(systimerLAPS > 0)
+/**
+ * @brief	add end-to-end time of the last completed run to the totals
+ * @brief	deferred from xSysTimerLap() so each lap costs no more than a single stop
+ */
+static void vSysTimerLapFlush(systimer_lap_t * psL) {
+	if (__atomic_exchange_n(&psL->Pend, 0, __ATOMIC_ACQ_REL)) {
+		systimer_t * pTot = &psL->Data[psL->Stages];
+		++pTot->Count;
+		vSysTimerUpdate(pTot, psL->tTotal);
+	}
+}
+
+void vSysTimerLapInit(u8_t LapNum, int Type, const char * Tag, u8_t Stages, const char * const * Name, ...) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS && INRANGE(stTICKS, Type, stCLOCKS));
+	IF_myASSERT(debugPARAM, INRANGE(1, Stages, systimerLAP_STAGES) && halMemoryANY((void *)Name));
+	systimer_lap_t * psL = &SLdata[LapNum];
+	psL->Tag = Tag;
+	psL->Name = Name;
+	psL->Type = Type;
+	psL->Stages = Stages;
+	psL->Stage = stLAP_IDLE;
+	psL->Pend = 0;
+	#if	(systimerSCATTER > 2)
+		va_list vaList;
+		va_start(vaList, Name);
+		u32_t SGmin	= va_arg(vaList, u32_t);			// end-to-end limits, also default for stages
+		u32_t SGmax	= va_arg(vaList, u32_t);
+		va_end(vaList);
+		IF_myASSERT(debugPARAM, SGmin < SGmax);
+	#endif
+	for (int Idx = 0; Idx <= Stages; ++Idx) {
+		vSysTimerClear(&psL->Data[Idx]);
+		#ifndef CONFIG_FREERTOS_UNICORE
+			psL->Data[Idx].Skip = 0;
+		#endif
+		#if	(systimerSCATTER > 2)
+			psL->Data[Idx].SGmin = SGmin;
+			psL->Data[Idx].SGmax = SGmax;
+		#endif
+	}
+}
+
+#if	(systimerSCATTER > 2)
+void vSysTimerLapSetScatter(u8_t LapNum, u8_t Stage, u32_t SGmin, u32_t SGmax) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS && Stage <= SLdata[LapNum].Stages && SGmin < SGmax);
+	systimer_t * pST = &SLdata[LapNum].Data[Stage];
+	pST->SGmin = SGmin;
+	pST->SGmax = SGmax;
+	memset(&pST->Group, 0, SO_MEM(systimer_t, Group));
+}
+#endif
+
+void vSysTimerLapDeInit(u8_t LapNum) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS);
+	memset(&SLdata[LapNum], 0, sizeof(systimer_lap_t));	// type 0=stUNDEF
+	SLdata[LapNum].Stage = stLAP_IDLE;
+}
+
+void vSysTimerLapReset(u8_t LapNum) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS);
+	systimer_lap_t * psL = &SLdata[LapNum];
+	psL->Stage = stLAP_IDLE;
+	psL->Pend = 0;
+	for (int Idx = 0; Idx <= psL->Stages; ++Idx)
+		vSysTimerClear(&psL->Data[Idx]);
+}
+
+u32_t xSysTimerLapStart(u8_t LapNum) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS && SLdata[LapNum].Type != stUNDEF);
+	systimer_lap_t * psL = &SLdata[LapNum];
+	if (psL->Type == stUNDEF)
+		return 0;
+	vSysTimerLapFlush(psL);								// previous run, before timestamp
+	#ifndef CONFIG_FREERTOS_UNICORE
+		psL->Core = xPortGetCoreID();
+	#endif
+	psL->Stage = 0;										// open first stage
+	return psL->tStart = psL->tMark = xSysTimerGetTime(psL->Type);
+}
+
+u32_t xSysTimerLap(u8_t LapNum) {
+	IF_myASSERT(debugPARAM, LapNum < systimerLAPS);
+	systimer_lap_t * psL = &SLdata[LapNum];
+	u32_t tNow = xSysTimerGetTime(psL->Type);			// single timestamp closes & opens stages
+	if (psL->Type == stUNDEF || psL->Stage >= psL->Stages)	// not initialised or stLAP_IDLE
+		return 0;
+	systimer_t * pST = &psL->Data[psL->Stage];
+	#ifndef CONFIG_FREERTOS_UNICORE
+	if (psL->Type == stCLOCKS && psL->Core != xPortGetCoreID()) {
+		++pST->Skip;									// see xSysTimerStop(), abandon rest of run
+		++psL->Data[psL->Stages].Skip;
+		psL->Stage = stLAP_IDLE;
+		return 0;
+	}
+	#endif
+	u32_t tElap = tNow - psL->tMark;
+	psL->tMark = tNow;									// next stage opens where this one closed
+	++pST->Count;
+	vSysTimerUpdate(pST, tElap);						// same cost as a stop
+	if (++psL->Stage == psL->Stages) {					// last stage closed ?
+		psL->Stage = stLAP_IDLE;
+		psL->tTotal = tNow - psL->tStart;				// end-to-end applied by vSysTimerLapFlush()
+		__atomic_store_n(&psL->Pend, 1, __ATOMIC_RELEASE);
+	}
+	return tElap;
+}
+#endif
+
 // ################################## Timer status reporting #######################################
 
 #if (CONFIG_FREERTOS_HZ == MILLIS_IN_SECOND)
@@ -240,66 +524,352 @@ u64_t xSysTimerGetElapsedSecs(u8_t TimNum) {
 #define stHDR_FMT2		"X-MCU-Y|"
 #define stDTL_FMT1		"|%2d%c|%8s|%#'7lu|"
 #define stDTL_FMT2		"%#'7lu|%#'7lu|%#'7lu|%#'7lu|%#'7llu|"
+#define stDTL_FMT3		"%#'7lu|"
+#define stSCT_FMT		"  %d:%#'lu~%#'lu=%#'lu"
+#define stHDR_CPU		"MinCPU |MaxCPU |AvgCPU |MaxOff |AvgOff |"
+#define stDTL_CPU		"%#'7lu|%#'7lu|%#'7lu|%#'7lu|%#'7lu|"
+
+#define	stLINE_BASE		(48 + 96 + 16)					// FMT1 + FMT2 + Skip, with grouping
+#if	(systimerCPU > 0)
+	#define	stLINE_CPU	80								// 5x CPU columns
+#else
+	#define	stLINE_CPU	0
+#endif
+#if	(systimerSCATTER > 2)
+	#define	stLINE_SCT	(systimerSCATTER * 48)
+#else
+	#define	stLINE_SCT	0
+#endif
+#define	stLINE_SIZE		(stLINE_BASE + stLINE_CPU + stLINE_SCT + sizeof(strNL))
+#define	stHDR_SIZE		144
+
+#if	(systimerSCATTER > 2)
+/**
+ * @brief	calculate the lower & upper limits of a scatter group bucket
+ * @param	pST pointer to timer structure
+ * @param	Idx scatter group bucket index
+ * @param[out]	pRlo & pRhi lower and upper limits
+ */
+static void vSysTimerScatterRange(systimer_t * pST, int Idx, u32_t * pRlo, u32_t * pRhi) {
+	if (Idx == 0) {
+		*pRlo = 0;
+		*pRhi = pST->SGmin;
+	} else if (Idx == (systimerSCATTER-1)) {
+		*pRlo = pST->SGmax;
+		*pRhi = 0xFFFFFFFF;
+	} else {
+		u32_t Rtmp = (pST->SGmax - pST->SGmin) / (systimerSCATTER-2);
+		*pRlo = ((Idx - 1) * Rtmp) + pST->SGmin;
+		*pRhi = *pRlo + Rtmp;
+	}
+}
+#endif
+
+#if	(systimerCPU > 0)
+/**
+ * @brief	format on-CPU & off-CPU columns for a timer with attribution enabled
+ * @return	number of characters written
+ */
+static int xSysTimerCpuFormat(char * pBuf, size_t Size, systimer_t * pST) {
+	u32_t Count = pST->Count ? pST->Count : 1;
+	return snprintfx(pBuf, Size, stDTL_CPU, pST->CpuMin, pST->CpuMax,
+		(u32_t) ((pST->Sum - pST->Off) / Count), pST->OffMax, (u32_t) (pST->Off / Count));
+}
+
+/**
+ * @brief	check if any selected timer of the specified type has on-CPU attribution enabled
+ */
+static int xSysTimerCpuColumns(u32_t TimerMask, int Type) {
+	for (u32_t Todo = TimerMask & STcpu; Todo; Todo &= Todo - 1) {
+		if (xSysTimerGetType(__builtin_ctz(Todo)) == Type)
+			return 1;
+	}
+	return 0;
+}
+#endif
+
+/**
+ * @brief	clamp snprintfx() return value to buffer size, allows chained appends
+ */
+static size_t xSysTimerClamp(size_t Len, int iRV, size_t Size) {
+	Len += (iRV > 0) ? iRV : 0;
+	return (Len < Size) ? Len : Size - 1;
+}
+
+static const char * pcSysTimerTag(systimer_t * pST, int Num, char * pBuf, size_t Size) {
+	if (halMemoryANY((void *)pST->Tag))					// if tag provided
+		return pST->Tag;								// use it
+	snprintfx(pBuf, Size, "T#%d+%d", pST->Tag, Num - (int)pST->Tag);	// else fabricate a tag
+	return pBuf;
+}
+
+/**
+ * @brief	format type specific header, shared by vSysTimerShow() & background reporter
+ * @return	length of header, always terminated with strNL
+ */
+static size_t xSysTimerFormatHeader(char * pBuf, size_t Size, int Type, int Cpu) {
+	Size -= sizeof(strNL) - 1;							// reserve space for strNL
+	size_t Len = xSysTimerClamp(0, snprintfx(pBuf, Size, stHDR_FMT1, xpfCOL(colourFG_CYAN,0),
+		(Type == stTICKS) ? stHDR_MILLIS :
+		(Type == stMICROS) ? stHDR_MICROS : stHDR_CLOCKS,
+		xpfCOL(attrRESET,0)), Size);
+	#ifndef CONFIG_FREERTOS_UNICORE
+		if (Type == stCLOCKS)							// add CLOCK specific header info
+			Len = xSysTimerClamp(Len, snprintfx(pBuf+Len, Size-Len, stHDR_FMT2), Size);
+	#endif
+	if (Cpu)											// add on/off CPU header info
+		Len = xSysTimerClamp(Len, snprintfx(pBuf+Len, Size-Len, stHDR_CPU), Size);
+	memcpy(pBuf+Len, strNL, sizeof(strNL));				// terminate header
+	return Len + sizeof(strNL) - 1;
+}
+
+/**
+ * @brief	format timer detail line, shared by vSysTimerShow() & background reporter
+ * @return	length of line, always terminated with strNL even if truncated
+ */
+static size_t xSysTimerFormatDetail(char * pBuf, size_t Size, int Num, int Run, int Type, int Cpu, const char * pcTag, systimer_t * pST) {
+	Size -= sizeof(strNL) - 1;							// reserve space for strNL
+	size_t Len = xSysTimerClamp(0, snprintfx(pBuf, Size, stDTL_FMT1, Num, Run ? 'R' : ' ', pcTag, pST->Count), Size);
+	Len = xSysTimerClamp(Len, snprintfx(pBuf+Len, Size-Len, stDTL_FMT2, pST->Last, pST->Min, pST->Max,
+		(u32_t) (pST->Count ? (pST->Sum / pST->Count) : pST->Sum), pST->Sum), Size);
+	#ifndef CONFIG_FREERTOS_UNICORE
+		if (Type == stCLOCKS)							// add CLOCK specific details
+			Len = xSysTimerClamp(Len, snprintfx(pBuf+Len, Size-Len, stDTL_FMT3, pST->Skip), Size);
+	#endif
+	#if	(systimerCPU > 0)
+		if (Cpu)										// add on/off CPU details
+			Len = xSysTimerClamp(Len, xSysTimerCpuFormat(pBuf+Len, Size-Len, pST), Size);
+	#endif
+	#if	(systimerSCATTER > 2)	// add scatter info
+		u32_t Rlo, Rhi;
+		for (int Idx = 0; Idx < systimerSCATTER; ++Idx) {
+			if (pST->Group[Idx]) {
+				vSysTimerScatterRange(pST, Idx, &Rlo, &Rhi);
+				Len = xSysTimerClamp(Len, snprintfx(pBuf+Len, Size-Len, stSCT_FMT, Idx, Rlo, Rhi, pST->Group[Idx]), Size);
+			}
+		}
+	#endif
+	memcpy(pBuf+Len, strNL, sizeof(strNL));				// end of scatter groups for specific timer
+	return Len + sizeof(strNL) - 1;
+}
+
+static void vSysTimerShowHeader(report_t * psR, int Type, int Cpu) {
+	char caBuf[stHDR_SIZE];
+	xSysTimerFormatHeader(caBuf, sizeof(caBuf), Type, Cpu);
+	xReport(psR, "%s", caBuf);
+}
+
+static void vSysTimerShowDetail(report_t * psR, int Num, int Run, int Type, int Cpu, const char * pcTag, systimer_t * pST) {
+	char caBuf[stLINE_SIZE];
+	xSysTimerFormatDetail(caBuf, sizeof(caBuf), Num, Run, Type, Cpu, pcTag, pST);
+	xReport(psR, "%s", caBuf);
+}
+
+#if	(systimerLAPS > 0)
+static void vSysTimerShowLaps(report_t * psR) {
+	systimer_lap_t * psL = SLdata;
+	for (int LapNum = 0; LapNum < systimerLAPS; ++LapNum, ++psL) {
+		if (psL->Type == stUNDEF)
+			continue;
+		vSysTimerLapFlush(psL);							// include last completed run
+		systimer_t * pTot = &psL->Data[psL->Stages];	// end-to-end totals
+		if (psL->Data[0].Count == 0 && psL->Stage == stLAP_IDLE)	// nothing measured yet
+			continue;
+		xReport(psR, "%CLap %d: %s%C" strNL, xpfCOL(colourFG_CYAN,0), LapNum, psL->Tag ? psL->Tag : "", xpfCOL(attrRESET,0));
+		vSysTimerShowHeader(psR, psL->Type, 0);
+		for (int Stage = 0; Stage < psL->Stages; ++Stage)
+			vSysTimerShowDetail(psR, Stage, Stage == psL->Stage, psL->Type, 0, psL->Name[Stage], &psL->Data[Stage]);
+		vSysTimerShowDetail(psR, psL->Stages, psL->Stage != stLAP_IDLE, psL->Type, 0, "Total", pTot);
+	}
+}
+#endif
 
 void vSysTimerShow(report_t * psR, u32_t TimerMask) {
-	const char * pcTag;
 	char caTmp[12];
 	for (int Type = stTICKS; Type < stMAX_TYPE; ++Type) {			// order tabled output by type
 		u32_t Mask = 0x00000001;									// start with lowest timer number
 		int HdrDone = 0;											// Ensure header output per type
+		#if	(systimerCPU > 0)
+			int CpuCols = xSysTimerCpuColumns(TimerMask, Type);		// on/off CPU columns required
+		#else
+			int CpuCols = 0;
+		#endif
 		for (int Num = 0; Num < stMAX_NUM; Mask <<= 1, ++Num) {		// loop through all timers
 			systimer_t * pST = &STdata[Num];
 			if ((TimerMask & Mask) && (Type == xSysTimerGetType(Num)) && pST->Count) {	// check timer, type & count
 				if (HdrDone == 0) {										// if header not done for this type
-					xReport(psR, stHDR_FMT1, xpfCOL(colourFG_CYAN,0),	// report type specific header
-						(Type == stTICKS) ? stHDR_MILLIS :
-						(Type == stMICROS) ? stHDR_MICROS : stHDR_CLOCKS,
-						xpfCOL(attrRESET,0));
-					#ifndef CONFIG_FREERTOS_UNICORE
-						if (Type == stCLOCKS)				// add CLOCK specific header info
-							xReport(psR, stHDR_FMT2);
-					#endif
-					xReport(psR, strNL);				// termimate header
+					vSysTimerShowHeader(psR, Type, CpuCols);
 					HdrDone = 1;						// mark as being done
 				}
-				if (halMemoryANY((void *)pST->Tag)) {	// if tag provided
-					pcTag = pST->Tag;					// use it
-				} else {								// else fabricate a tab
-					snprintfx(caTmp, sizeof(caTmp), "T#%d+%d", pST->Tag, Num - (int)pST->Tag);
-					pcTag = caTmp;						// use fabricated tab
-				}
-				xReport(psR, stDTL_FMT1, Num, (STstat & (1UL << Num)) ? 'R' : ' ', pcTag, pST->Count);
-				xReport(psR, stDTL_FMT2, pST->Last, pST->Min, pST->Max,(u32_t) (pST->Count ? (pST->Sum / pST->Count) : pST->Sum), pST->Sum);
-				#ifndef CONFIG_FREERTOS_UNICORE
-					if (Type == stCLOCKS)				// add CLOCK specific details
-						xReport(psR, "%#'7lu|", pST->Skip);
-				#endif
-				#if	(systimerSCATTER > 2)	// add scatter info
-					u32_t Rlo, Rhi;
-					for (int Idx = 0; Idx < systimerSCATTER; ++Idx) {
-						if (pST->Group[Idx]) {
-							if (Idx == 0) {
-								Rlo = 0;
-								Rhi = pST->SGmin;
-							} else if (Idx == (systimerSCATTER-1)) {
-								Rlo = pST->SGmax;
-								Rhi = 0xFFFFFFFF;
-							} else {
-								u32_t Rtmp = (pST->SGmax - pST->SGmin) / (systimerSCATTER-2);
-								Rlo	= ((Idx - 1) * Rtmp) + pST->SGmin;
-								Rhi = Rlo + Rtmp;
-							}
-							xReport(psR, "  %d:%#'lu~%#'lu=%#'lu", Idx, Rlo, Rhi, pST->Group[Idx]);
-						}
-					}
+				#if	(systimerCPU > 0)
+					int Cpu = (STcpu & Mask) ? 1 : 0;
+				#else
+					int Cpu = 0;
 				#endif
-				xReport(psR, strNL);		// end of scatter groups for specific timer
+				vSysTimerShowDetail(psR, Num, STstat & Mask, Type, Cpu, pcSysTimerTag(pST, Num, caTmp, sizeof(caTmp)), pST);
 			}
 		}
 	}
+	#if	(systimerLAPS > 0)
+		if (TimerMask & stLAP_MASK)						// lap timers as grouped blocks
+			vSysTimerShowLaps(psR);
+	#endif
 	xReport(psR, strNL);
 }
 
+// ############################### Background status reporting #####################################
+
+#if	(systimerREPORT > 0)
+#define	systimerREPORT_PRIO			(tskIDLE_PRIORITY + 1)
+#define	systimerREPORT_STACK		3072
+
+typedef struct {
+	report_t * psR;										// output destination
+	u64_t Type;											// copy of STtype
+	u32_t Stat;											// copy of STstat
+	u32_t Cpu;											// copy of STcpu
+	u32_t Mask;											// timers to be reported
+	u32_t Dirty;										// timers copied since last render
+	systimer_t Data[stMAX_NUM];
+} systimer_snap_t;
+
+static systimer_snap_t STsnap[2] = { 0 };				// [STrBack] filled by caller, other by task
+static char STrLine[stMAX_NUM][stLINE_SIZE];			// preformatted timer detail lines
+static u16_t STrLen[stMAX_NUM] = { 0 };					// 0 = nothing to report
+static u8_t STrType[stMAX_NUM] = { 0 };					// type when line was formatted
+static u32_t STrValid = 0;								// lines formatted at least once
+static u32_t STrCpu = 0;								// lines formatted with on/off CPU columns
+static u8_t STrBack = 0, STrBusy = 0, STrPend = 0;
+static TaskHandle_t STrTask = NULL;
+static portMUX_TYPE STrMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief	format single timer detail line from snapshot into line cache
+ */
+static void vSysTimerReportLine(systimer_snap_t * psS, int Num) {
+	systimer_t * pST = &psS->Data[Num];
+	int Type = maskGET2B(psS->Type, Num, u64_t);
+	STrType[Num] = Type;
+	if (Type == stUNDEF || pST->Count == 0) {
+		STrLen[Num] = 0;
+		return;
+	}
+	char caTmp[12];
+	int Cpu = (psS->Cpu & (1UL << Num)) ? 1 : 0;
+	STrCpu = Cpu ? (STrCpu | (1UL << Num)) : (STrCpu & ~(1UL << Num));
+	STrLen[Num] = xSysTimerFormatDetail(STrLine[Num], sizeof(STrLine[Num]), Num, psS->Stat & (1UL << Num),
+		Type, Cpu, pcSysTimerTag(pST, Num, caTmp, sizeof(caTmp)), pST);
+}
+
+/**
+ * @brief	re-render changed lines then output header(s) and cached lines
+ */
+static void vSysTimerReportRender(systimer_snap_t * psS) {
+	for (u32_t Todo = psS->Dirty; Todo; Todo &= Todo - 1) {
+		int Num = __builtin_ctz(Todo);
+		vSysTimerReportLine(psS, Num);
+		STrValid |= (1UL << Num);
+	}
+	char caHdr[stHDR_SIZE];
+	for (int Type = stTICKS; Type < stMAX_TYPE; ++Type) {
+		int HdrDone = 0, CpuCols = 0;
+		for (int Num = 0; Num < stMAX_NUM; ++Num) {
+			if ((psS->Mask & STrCpu & (1UL << Num)) && STrType[Num] == Type && STrLen[Num])
+				CpuCols = 1;
+		}
+		for (int Num = 0; Num < stMAX_NUM; ++Num) {
+			if ((psS->Mask & (1UL << Num)) == 0 || STrType[Num] != Type || STrLen[Num] == 0)
+				continue;
+			if (HdrDone == 0) {
+				xSysTimerFormatHeader(caHdr, sizeof(caHdr), Type, CpuCols);
+				xReport(psS->psR, "%s", caHdr);
+				HdrDone = 1;
+			}
+			xReport(psS->psR, "%s", STrLine[Num]);		// blocking here only delays this task
+		}
+	}
+	xReport(psS->psR, strNL);
+}
+
+static void vSysTimerReportTask(void * pvPara) {
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		int Again;
+		do {
+			systimer_snap_t * psS = &STsnap[STrBack ^ 1];	// STrBack only changes while we are busy
+			vSysTimerReportRender(psS);
+			psS->Dirty = 0;								// about to become the back buffer
+			portENTER_CRITICAL(&STrMux);
+			if (STrPend) {								// triggered again while rendering ?
+				STrPend = 0;
+				STrBack ^= 1;							// swap, keep going
+				Again = 1;
+			} else {
+				STrBusy = Again = 0;
+			}
+			portEXIT_CRITICAL(&STrMux);
+		} while (Again);
+	}
+}
+
+void vSysTimerReportInit(void) {
+	if (STrTask)
+		return;
+	BaseType_t xRV = xTaskCreate(vSysTimerReportTask, "systimer", systimerREPORT_STACK, NULL, systimerREPORT_PRIO, &STrTask);
+	IF_myASSERT(debugRESULT, xRV == pdPASS);
+	if (xRV != pdPASS)
+		STrTask = NULL;
+}
+
+int xSysTimerReportTrigger(report_t * psR, u32_t TimerMask) {
+	if (STrTask == NULL)
+		return 0;
+	int Notify;
+	TimerMask &= (1UL << stMAX_NUM) - 1;
+	portENTER_CRITICAL(&STrMux);
+	systimer_snap_t * psS = &STsnap[STrBack];
+	if (STrPend) {										// already queued behind current render ?
+		if (psS->psR != psR) {							// for another destination, don't drop it
+			portEXIT_CRITICAL(&STrMux);
+			return 0;
+		}
+		TimerMask |= psS->Mask;							// same destination, coalesce
+	}
+	u32_t Dirty = __atomic_fetch_and(&STdirty, ~TimerMask, __ATOMIC_ACQUIRE);
+	u32_t Copy = TimerMask & (Dirty | ~STrValid);		// changed or never formatted
+	for (u32_t Todo = Copy; Todo; Todo &= Todo - 1) {
+		int Num = __builtin_ctz(Todo);
+		memcpy(&psS->Data[Num], &STdata[Num], sizeof(systimer_t));
+	}
+	psS->psR = psR;
+	psS->Type = STtype;
+	psS->Stat = STstat;
+	#if	(systimerCPU > 0)
+		psS->Cpu = STcpu;
+	#endif
+	psS->Mask = TimerMask;
+	psS->Dirty |= Copy;								// accumulate if not yet swapped
+	if (STrBusy) {										// task still rendering front buffer
+		STrPend = 1;									// it will swap & render when done
+		Notify = 0;
+	} else {
+		STrBack ^= 1;
+		STrBusy = Notify = 1;
+	}
+	portEXIT_CRITICAL(&STrMux);
+	if (Notify)
+		xTaskNotifyGive(STrTask);
+	return 1;
+}
+
+int xSysTimerReportBusy(report_t * psR) {
+	portENTER_CRITICAL(&STrMux);
+	int iRV = (STrBusy && STsnap[STrBack ^ 1].psR == psR) || (STrPend && STsnap[STrBack].psR == psR);
+	portEXIT_CRITICAL(&STrMux);
+	return iRV;
+}
+#endif
+
 // ################################### RTOS + HW delay support #####################################
 
 i64_t i64TaskDelayUsec(u32_t u32Period) {
@@ -340,6 +910,9 @@ void vClockDelayMsec(u32_t mSec) {
 #define	systimerTEST_MICROS			(systimerTESTFLAG & 0x0004)
 #define	systimerTEST_CLOCKS			(systimerTESTFLAG & 0x0008)
 #define	systimerTEST_MACROS			(systimerTESTFLAG & 0x0010)
+#define	systimerTEST_REPORT			(systimerTESTFLAG & 0x0020)
+#define	systimerTEST_LAPS			(systimerTESTFLAG & 0x0040)
+#define	systimerTEST_CPU			(systimerTESTFLAG & 0x0080)
 #define systimerTESTFLAG			0x0010
 #define	systimerINTERVAL			1000
 
@@ -361,6 +934,68 @@ static void vSysTimingTestSet(u32_t Type, char * Tag, u32_t Delay) {
 }
 #endif
 
+#if	(systimerTEST_REPORT && systimerREPORT > 0)
+static void vSysTimingTestReport(u32_t Delay) {
+	vSysTimerReportInit();
+	vSysTimerInit(0, stMICROS, "CHANGED", Delay, Delay * systimerSCATTER);
+	vSysTimerInit(1, stMICROS, "STATIC", Delay, Delay * systimerSCATTER);
+	for (int Num = 0; Num < 2; ++Num) {
+		xSysTimerStart(Num);
+		vClockDelayUsec(Delay);
+		xSysTimerStop(Num);
+	}
+	xReport(NULL, "Report #1, both timers formatted" strNL);
+	xSysTimerReportTrigger(NULL, 0x3);
+	while (xSysTimerReportBusy(NULL))					// wait for output before reusing psR
+		vTaskDelay(pdMS_TO_TICKS(10));
+	xSysTimerStart(0);									// change timer 0 only
+	vClockDelayUsec(Delay * 2);
+	xSysTimerStop(0);
+	xReport(NULL, "Report #2, only CHANGED re-formatted" strNL);
+	xSysTimerReportTrigger(NULL, 0x3);
+	while (xSysTimerReportBusy(NULL))
+		vTaskDelay(pdMS_TO_TICKS(10));
+	vSysTimerDeInit(0);
+	vSysTimerDeInit(1);
+}
+#endif
+
+#if	(systimerTEST_LAPS && systimerLAPS > 0)
+static void vSysTimingTestLaps(u32_t Delay) {
+	static const char * const Name[] = { "Read", "Convert", "Publish" };
+	vSysTimerLapInit(0, stMICROS, "PIPELINE", sizeof(Name) / sizeof(Name[0]), Name, Delay, Delay * 6 * 2);
+	for (int SI = 0; SI < systimerSCATTER; ++SI) {
+		xSysTimerLapStart(0);
+		vClockDelayUsec(Delay);							// Read
+		xSysTimerLap(0);
+		vClockDelayUsec(Delay * 2);						// Convert
+		xSysTimerLap(0);
+		vClockDelayUsec(Delay * 3);						// Publish
+		xSysTimerLap(0);
+	}
+	vSysTimerShow(NULL, stLAP_MASK);
+	vSysTimerLapDeInit(0);
+	vTaskDelay(pdMS_TO_TICKS(100));
+}
+#endif
+
+#if	(systimerTEST_CPU && systimerCPU > 0)
+static void vSysTimingTestCpu(u32_t Delay) {
+	vSysTimerInit(0, stMICROS, "CPU", Delay, Delay * 20);
+	vSysTimerSetCpuMask(1);
+	for (int SI = 0; SI < systimerSCATTER; ++SI) {
+		xSysTimerStart(0);
+		vClockDelayUsec(Delay);							// on-CPU
+		vTaskDelay(pdMS_TO_TICKS(10));					// blocked, expect ~10mS Off
+		xSysTimerStop(0);
+	}
+	vSysTimerShow(NULL, 1);
+	vSysTimerSetCpuMask(0);
+	vSysTimerDeInit(0);
+	vTaskDelay(pdMS_TO_TICKS(100));
+}
+#endif
+
 void vSysTimingTest(void) {
 #if	(systimerTEST_DELAY)								/* Test the uSec delays */
 	u32_t uClock, uSecs;
@@ -424,4 +1059,16 @@ void vSysTimingTest(void) {
 	PX("\tIn=%lu  Out=%lu" strNL, 4200000, u32SecToTicks(4200000));
 	// works up to 42000000 @ 100Hz, 4200000 @ 1000Hz, 420000 @ 10000Hz 
 #endif
+
+#if (systimerTEST_REPORT && systimerREPORT > 0)		/* Test background reporting */
+	vSysTimingTestReport(100);
+#endif
+
+#if (systimerTEST_LAPS && systimerLAPS > 0)				/* Test lap timers, stages & total */
+	vSysTimingTestLaps(100);
+#endif
+
+#if (systimerTEST_CPU && systimerCPU > 0)				/* Test on-CPU vs blocked attribution */
+	vSysTimingTestCpu(1000);
+#endif
 }
@@ -24,6 +24,20 @@ extern "C" {
 #define	IF_SYSTIMER_SHOW(T,n)					if (T && ((n) < 31)) vSysTimerShow(NULL, n)
 #define	IF_SYSTIMER_SHOW_NUM(T,n)				if (T && ((n) < 31)) vSysTimerShow(NULL, 1 << (n))
 
+// Enable background reporter, timers snapshotted in caller context, formatted by low priority task
+#define	systimerREPORT							0
+
+// Lap/split timers, each with up to systimerLAP_STAGES stages, 0 to disable
+#define	systimerLAPS							2
+#define	systimerLAP_STAGES						6
+#define	stLAP_MASK								(1UL << 31)		// vSysTimerShow() lap blocks
+
+// Split measurements into on-CPU and preempted/blocked time, requires in FreeRTOSConfig.h
+//	#define configUSE_APPLICATION_TASK_TAG	1			// owner tasks tagged with running timer mask
+//	#define traceTASK_SWITCHED_OUT()	vSysTimerTaskSwitchedOut()
+//	#define traceTASK_SWITCHED_IN()		vSysTimerTaskSwitchedIn()
+#define	systimerCPU								0
+
 // ################################# Process timer support #########################################
 
 enum { stUNDEF, stTICKS, stMICROS, stCLOCKS, stMAX_TYPE };
@@ -178,6 +192,13 @@ typedef struct __attribute__((packed)) {
 	#else
 		#define stSCATTER_OVERHEAD		0
 	#endif
+	#if	(systimerCPU > 0)
+		u64_t Off;								// sum of preempted/blocked time
+		u32_t CpuMin, CpuMax, OffMax;
+		#define stCPU_OVERHEAD			(sizeof(u64_t) + (3 * sizeof(u32_t)))
+	#else
+		#define stCPU_OVERHEAD			0
+	#endif
 	#ifndef CONFIG_FREERTOS_UNICORE
 		u32_t Skip;
 		#define stDUALCORE_OVERHEAD		sizeof(u32_t)
@@ -185,7 +206,7 @@ typedef struct __attribute__((packed)) {
 		#define stDUALCORE_OVERHEAD		0
 	#endif
 } systimer_t;
-DUMB_STATIC_ASSERT(sizeof(systimer_t) == 24 + sizeof(char *) + stSCATTER_OVERHEAD + stDUALCORE_OVERHEAD);
+DUMB_STATIC_ASSERT(sizeof(systimer_t) == 24 + sizeof(char *) + stSCATTER_OVERHEAD + stCPU_OVERHEAD + stDUALCORE_OVERHEAD);
 
 // ######################################### Public variables ######################################
 
@@ -219,6 +240,67 @@ u32_t xSysTimerToggle(u8_t TimNum);
  */
 void vSysTimerResetCountersMask(u32_t TimerMask);
 
+#if	(systimerCPU > 0)
+/**
+ * @brief	select timers for which measurements are split into on-CPU and preempted/blocked time
+ * @brief	statistics of timers added or removed are reset, timers should be stopped when changed
+ * @param	TimerMask bitmapped flag to select timer(s)
+ */
+void vSysTimerSetCpuMask(u32_t TimerMask);
+
+/**
+ * @brief	task switch hooks, call from traceTASK_SWITCHED_OUT() & traceTASK_SWITCHED_IN()
+ * @brief	application task tag of the owner holds its running timer mask, other tasks cost a single tag load
+ * @brief	stCLOCKS measurement switched out & in on different cores is discarded and counted in Skip
+ */
+void vSysTimerTaskSwitchedOut(void);
+
+void vSysTimerTaskSwitchedIn(void);
+#endif
+
+// ################################# Lap/split timer support #######################################
+
+#if	(systimerLAPS > 0)
+/**
+ * @brief	initialise a lap timer with a number of named stages
+ * @param	LapNum lap timer number
+ * @param	Type stTICKS, stMICROS or stCLOCKS
+ * @param	Tag name of the lap timer (pipeline)
+ * @param	Stages number of stages, 1 to systimerLAP_STAGES
+ * @param	Name array of Stages stage names, MUST remain valid while initialised
+ * @param	... SGmin & SGmax scatter limits for end-to-end and (default) all stages
+ */
+void vSysTimerLapInit(u8_t LapNum, int Type, const char * Tag, u8_t Stages, const char * const * Name, ...);
+
+#if	(systimerSCATTER > 2)
+/**
+ * @brief	override scatter limits for a single stage, Stage == Stages for end-to-end
+ */
+void vSysTimerLapSetScatter(u8_t LapNum, u8_t Stage, u32_t SGmin, u32_t SGmax);
+#endif
+
+void vSysTimerLapDeInit(u8_t LapNum);
+
+void vSysTimerLapReset(u8_t LapNum);
+
+/**
+ * @brief	start a new run of the lap timer, opens first stage
+ * @param	LapNum
+ * @return	current timer value based on type (CLOCKs or TICKs)
+ */
+u32_t xSysTimerLapStart(u8_t LapNum);
+
+/**
+ * @brief	close the current stage and open the next from a single timestamp, costs a single stop
+ * @brief	closing the last stage ends the run, end-to-end statistics are updated by the next
+ * @brief	xSysTimerLapStart() (before its timestamp) or vSysTimerShow()
+ * @brief	on a cross-core skip the open stage and Total count Skip, closed stages of that run remain
+ * @param	LapNum
+ * @return	measured interval of the stage just closed, 0 if not running
+ */
+u32_t xSysTimerLap(u8_t LapNum);
+#endif
+
 // ################################### Public Status APIs ##########################################
 
 /**
@@ -252,11 +334,36 @@ struct report_t;
 /**
  * @brief	display the current value(s) of the specified timer(s)
  * @brief	MUST do a SysTimerStop() before calling to freeze accurate value in array
- * @param	tMask 8bit bitmapped flag to select timer(s) to display
+ * @param	tMask 8bit bitmapped flag to select timer(s) to display, stLAP_MASK for lap timers
  * @return	none
  */
 void vSysTimerShow(struct report_t * psR, u32_t TimerMask);
 
+#if	(systimerREPORT > 0)
+/**
+ * @brief	create the low priority background reporting task, call once during startup
+ */
+void vSysTimerReportInit(void);
+
+/**
+ * @brief	snapshot changed timer(s) and queue report to be formatted & output by background task
+ * @brief	only timers started/stopped/reset since previous report are copied and re-rendered
+ * @brief	while a report is pending, further triggers for the same psR are merged into it
+ * @param	psR report control structure, NULL for console, else MUST remain valid until
+ * 			xSysTimerReportBusy(psR) returns 0
+ * @param	TimerMask bitmapped flag to select timer(s) to display
+ * @return	1 if snapshot queued, 0 if reporting task not running or report for other psR pending
+ */
+int xSysTimerReportTrigger(struct report_t * psR, u32_t TimerMask);
+
+/**
+ * @brief	check if a queued or active report still references psR
+ * @param	psR report control structure as passed to xSysTimerReportTrigger()
+ * @return	1 if report for psR not yet completely output, 0 if psR can be released
+ */
+int xSysTimerReportBusy(struct report_t * psR);
+#endif
+
 // ################################### RTOS + HW delay support #####################################
 
 /**